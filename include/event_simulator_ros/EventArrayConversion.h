@@ -0,0 +1,46 @@
+/* Conversion of simulated events into the prophesee ROS message format.
+ */
+
+#pragma once
+
+#include <prophesee_event_msgs/EventArray.h>
+#include <std_msgs/Header.h>
+
+#include <cstdint>
+
+/**
+ * @brief Fills an event array message with the simulated events.
+ *        The message is reused, i.e. its event buffer is cleared but
+ *        keeps its capacity between calls.
+ *
+ * @param events Simulated events of one frame pair, the time stamps are
+ *        relative to base_timestamp_ns
+ * @param base_timestamp_ns Absolute time stamp the event time stamps are
+ *        relative to [ns]
+ * @param header Header of the frame the events were simulated for
+ * @param width Width of the frames
+ * @param height Height of the frames
+ * @param event_array_msg Event array message to fill
+ */
+template <typename EventContainer>
+inline void toEventArrayMsg(const EventContainer &events,
+                            const std::uint64_t base_timestamp_ns,
+                            const std_msgs::Header &header,
+                            const unsigned int width,
+                            const unsigned int height,
+                            prophesee_event_msgs::EventArray &event_array_msg) {
+  event_array_msg.header = header;
+  event_array_msg.width = width;
+  event_array_msg.height = height;
+  event_array_msg.events.clear();
+  event_array_msg.events.reserve(events.size());
+
+  prophesee_event_msgs::Event event_msg;
+  for (const auto &event : events) {
+    event_msg.x = event.x;
+    event_msg.y = event.y;
+    event_msg.ts.fromNSec(base_timestamp_ns + event.timestamp);
+    event_msg.polarity = event.polarity;
+    event_array_msg.events.push_back(event_msg);
+  }
+}
@@ -0,0 +1,36 @@
+/* Conversion of received ROS image messages into the frames used by the
+ * event simulator.
+ */
+
+#pragma once
+
+#include <cv_bridge/cv_bridge.h>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/image_encodings.h>
+
+#include <cstdint>
+#include <opencv2/imgproc.hpp>
+
+/**
+ * @brief Converts an image message into a grey scale frame.
+ *
+ * @note: Throws cv_bridge::Exception if the image can not be converted
+ *
+ * @param msg ROS message containing the frame
+ * @param cv_ptr CV bridge image the BGR frame is copied to
+ * @param grey_frame Grey scale frame (newly allocated, shallow copies of the
+ *        previous frame are not modified)
+ * @param timestamp_ns Absolute time stamp of the frame [ns]
+ */
+inline void toGreyFrame(const sensor_msgs::Image::ConstPtr &msg,
+                        cv_bridge::CvImagePtr &cv_ptr, cv::Mat &grey_frame,
+                        std::uint64_t &timestamp_ns) {
+  cv_ptr = cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8);
+
+  // The previous frame usually shares the buffer (prev_frame = grey_frame),
+  // so cvtColor has to allocate a new one instead of overwriting it
+  grey_frame.release();
+  cv::cvtColor(cv_ptr->image, grey_frame, cv::COLOR_BGR2GRAY);
+
+  timestamp_ns = msg->header.stamp.toNSec();
+}
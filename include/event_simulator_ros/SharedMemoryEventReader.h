@@ -0,0 +1,213 @@
+/* Consumer side of the shared memory event ring buffer. Header only and
+ * without ROS dependencies, link with -lrt on older glibc versions.
+ */
+
+#pragma once
+
+#include <event_simulator_ros/SharedMemoryEventRing.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reads events from a ring buffer in POSIX shared memory.
+ *        Any number of readers can be attached to the same ring buffer,
+ *        each reader keeps its own position.
+ */
+class SharedMemoryEventReader {
+ public:
+  /**
+   * @brief Constructor maps the shared memory object. Only events written
+   *        after the construction will be read.
+   *
+   * @param name Name of the shared memory object (e.g. "/events")
+   */
+  explicit SharedMemoryEventReader(const std::string &name) : name_{name} {
+    fd_ = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd_ < 0) {
+      throw std::runtime_error("shm_open failed for " + name + ": " +
+                               std::strerror(errno));
+    }
+
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) <
+            sizeof(SharedMemoryEventRingHeader)) {
+      close(fd_);
+      throw std::runtime_error("Shared memory " + name + " is not initialized");
+    }
+    size_ = file_stat.st_size;
+
+    void *memory = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (memory == MAP_FAILED) {
+      const std::string error = std::strerror(errno);
+      close(fd_);
+      throw std::runtime_error("mmap failed for " + name + ": " + error);
+    }
+    header_ = static_cast<const SharedMemoryEventRingHeader *>(memory);
+
+    if (header_->magic.load(std::memory_order_acquire) !=
+            kSharedMemoryEventRingMagic ||
+        header_->version != kSharedMemoryEventRingVersion ||
+        header_->capacity == 0 ||
+        header_->capacity > kSharedMemoryEventRingMaxCapacity ||
+        (header_->capacity & (header_->capacity - 1)) != 0 ||
+        size_ < sharedMemoryEventRingSize(header_->capacity)) {
+      munmap(memory, size_);
+      close(fd_);
+      throw std::runtime_error("Shared memory " + name +
+                               " is not a compatible event ring buffer");
+    }
+
+    capacity_ = header_->capacity;
+    slots_ = sharedMemoryEventSlots(header_);
+    cursor_ = header_->head.load(std::memory_order_acquire);
+  }
+
+  SharedMemoryEventReader(const SharedMemoryEventReader &) = delete;
+  SharedMemoryEventReader &operator=(const SharedMemoryEventReader &) = delete;
+
+  ~SharedMemoryEventReader() {
+    munmap(const_cast<SharedMemoryEventRingHeader *>(header_), size_);
+    close(fd_);
+  }
+
+  /**
+   * @brief Copies the events published since the last call. Events which
+   *        were overwritten before they could be read are skipped and
+   *        counted as lost.
+   *
+   * @param events Vector the events are written to (cleared before)
+   * @param max_events Maximum number of events to read
+   * @return Number of read events
+   */
+  std::size_t read(std::vector<SharedMemoryEvent> &events,
+                   const std::size_t max_events = SIZE_MAX) {
+    events.clear();
+
+    const std::uint64_t mask = capacity_ - 1;
+    std::uint64_t head = header_->head.load(std::memory_order_acquire);
+
+    while (cursor_ < head && events.size() < max_events) {
+      if (head - cursor_ > capacity_) {
+        // Overrun: the oldest events are already overwritten
+        lost_events_ += head - capacity_ - cursor_;
+        cursor_ = head - capacity_;
+      }
+
+      const auto &slot = slots_[cursor_ & mask];
+
+      // Seqlock: the event is only valid if the slot was not modified
+      // while it was copied
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      SharedMemoryEvent event;
+      std::memcpy(&event, &slot.event, sizeof(SharedMemoryEvent));
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if (sequence == cursor_ + 1 &&
+          slot.sequence.load(std::memory_order_relaxed) == sequence) {
+        events.emplace_back(event);
+      } else {
+        ++lost_events_;
+        head = header_->head.load(std::memory_order_acquire);
+      }
+      ++cursor_;
+    }
+
+    return events.size();
+  }
+
+  /**
+   * @brief Checks if the producer of the mapped ring buffer is still running,
+   *        i.e. it did not shut down and the shared memory object was not
+   *        replaced by a restarted producer. Opens the shared memory object
+   *        again, so do not call it for every read.
+   *
+   * @return False if a new reader has to be created
+   */
+  bool isProducerAlive() const {
+    if (header_->alive.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+
+    const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      return false;
+    }
+
+    // A new object might not be resized yet, mapping it would fault
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) <
+            sizeof(SharedMemoryEventRingHeader)) {
+      close(fd);
+      return false;
+    }
+
+    bool same_generation = false;
+    void *memory = mmap(nullptr, sizeof(SharedMemoryEventRingHeader),
+                        PROT_READ, MAP_SHARED, fd, 0);
+    if (memory != MAP_FAILED) {
+      same_generation =
+          static_cast<const SharedMemoryEventRingHeader *>(memory)
+              ->generation == header_->generation;
+      munmap(memory, sizeof(SharedMemoryEventRingHeader));
+    }
+    close(fd);
+
+    return same_generation;
+  }
+
+  /**
+   * @brief Returns the sequence number of the next event to read.
+   */
+  std::uint64_t getSequence() const { return cursor_; }
+
+  /**
+   * @brief Returns the number of events lost due to overruns.
+   */
+  std::uint64_t getLostEvents() const { return lost_events_; }
+
+  /**
+   * @brief Returns the width of the frames.
+   */
+  unsigned int getWidth() const { return header_->width; }
+
+  /**
+   * @brief Returns the height of the frames.
+   */
+  unsigned int getHeight() const { return header_->height; }
+
+ private:
+  /// Name of the shared memory object
+  std::string name_;
+
+  /// File descriptor of the shared memory object
+  int fd_;
+
+  /// Size of the shared memory object [bytes]
+  std::size_t size_;
+
+  /// Number of slots
+  std::uint64_t capacity_;
+
+  /// Header of the ring buffer
+  const SharedMemoryEventRingHeader *header_;
+
+  /// Slots of the ring buffer
+  const SharedMemoryEventSlot *slots_;
+
+  /// Sequence number of the next event to read
+  std::uint64_t cursor_;
+
+  /// Number of events lost due to overruns
+  std::uint64_t lost_events_ = 0;
+};
@@ -0,0 +1,146 @@
+/* Memory layout of the shared memory event ring buffer.
+ *
+ * The ring buffer lives in a POSIX shared memory object and consists of a
+ * header followed by a power of two number of slots. It is written by a
+ * single producer (see SharedMemoryEventWriter.h) and can be read by any
+ * number of consumers (see SharedMemoryEventReader.h) without locks.
+ *
+ * Every event gets a sequence number, starting at 0. The event with sequence
+ * number s is stored in slot s % capacity, the slot's sequence is set to s + 1
+ * once the event is completely written (0 while it is written). The producer
+ * publishes the number of written events in the header's head after each
+ * batch. Consumers detect overruns if a slot's sequence does not match the
+ * expected one.
+ *
+ * The producer clears the header's alive flag when it shuts down. A restarted
+ * producer replaces the shared memory object with a new one with a different
+ * generation, consumers which still map the old object can detect this by
+ * comparing the generations (see SharedMemoryEventReader::isProducerAlive).
+ *
+ * @note: This header has no ROS dependencies so that it can be used by
+ *        consumers outside of ROS.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/// Magic number identifying an initialized ring buffer ("EVRB")
+constexpr std::uint32_t kSharedMemoryEventRingMagic = 0x45565242;
+
+/// Version of the memory layout, has to be increased on every change
+constexpr std::uint32_t kSharedMemoryEventRingVersion = 2;
+
+/// Maximum number of slots
+constexpr std::uint64_t kSharedMemoryEventRingMaxCapacity = 1ull << 32;
+
+/**
+ * @brief Fixed binary layout of an event in the ring buffer.
+ */
+struct SharedMemoryEvent {
+  /// Time stamp [ns], absolute 64 bit time (e.g. ROS time), does not wrap
+  std::uint64_t timestamp_ns;
+
+  /// X coordinate
+  std::uint16_t x;
+
+  /// Y coordinate
+  std::uint16_t y;
+
+  /// Polarity (1: positive, 0: negative)
+  std::uint8_t polarity;
+
+  /// Unused, keeps the size at 16 bytes
+  std::uint8_t reserved[3];
+};
+
+static_assert(sizeof(SharedMemoryEvent) == 16,
+              "Unexpected size of SharedMemoryEvent");
+static_assert(std::is_trivially_copyable<SharedMemoryEvent>::value,
+              "SharedMemoryEvent has to be trivially copyable");
+
+/**
+ * @brief Slot of the ring buffer holding one event.
+ */
+struct alignas(32) SharedMemoryEventSlot {
+  /// Sequence number of the stored event + 1 (0 while the event is written)
+  std::atomic<std::uint64_t> sequence;
+
+  /// Stored event
+  SharedMemoryEvent event;
+};
+
+/**
+ * @brief Header at the beginning of the shared memory object.
+ */
+struct SharedMemoryEventRingHeader {
+  /// Set to kSharedMemoryEventRingMagic once the ring buffer is initialized
+  std::atomic<std::uint32_t> magic;
+
+  /// Version of the memory layout
+  std::uint32_t version;
+
+  /// Number of slots (power of two)
+  std::uint64_t capacity;
+
+  /// Width of the frames
+  std::uint32_t width;
+
+  /// Height of the frames
+  std::uint32_t height;
+
+  /// Unique per producer start (wall clock time of the creation [ns])
+  std::uint64_t generation;
+
+  /// 1 while the producer is running, 0 after it shut down
+  std::atomic<std::uint32_t> alive;
+
+  /// Number of events written so far (on its own cache line)
+  alignas(64) std::atomic<std::uint64_t> head;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Lock-free 64 bit atomics are required for the shared memory");
+
+/**
+ * @brief Size of the shared memory object for the given number of slots.
+ *
+ * @note: Throws std::invalid_argument if the capacity is 0 or larger than
+ *        kSharedMemoryEventRingMaxCapacity and std::overflow_error if the
+ *        size does not fit into std::size_t
+ *
+ * @param capacity Number of slots
+ * @return Size [bytes]
+ */
+inline std::size_t sharedMemoryEventRingSize(const std::uint64_t capacity) {
+  if (capacity == 0 || capacity > kSharedMemoryEventRingMaxCapacity) {
+    throw std::invalid_argument(
+        "Capacity of the ring buffer must be in [1, 2^32]");
+  }
+  if (capacity > (SIZE_MAX - sizeof(SharedMemoryEventRingHeader)) /
+                     sizeof(SharedMemoryEventSlot)) {
+    throw std::overflow_error("Size of the ring buffer exceeds size_t");
+  }
+  return sizeof(SharedMemoryEventRingHeader) +
+         capacity * sizeof(SharedMemoryEventSlot);
+}
+
+/**
+ * @brief Returns the slots following the header.
+ *
+ * @param header Header at the beginning of the shared memory object
+ * @return First slot
+ */
+inline SharedMemoryEventSlot *sharedMemoryEventSlots(
+    SharedMemoryEventRingHeader *header) {
+  return reinterpret_cast<SharedMemoryEventSlot *>(header + 1);
+}
+
+inline const SharedMemoryEventSlot *sharedMemoryEventSlots(
+    const SharedMemoryEventRingHeader *header) {
+  return reinterpret_cast<const SharedMemoryEventSlot *>(header + 1);
+}
@@ -0,0 +1,168 @@
+/* Producer side of the shared memory event ring buffer.
+ */
+
+#pragma once
+
+#include <event_simulator_ros/SharedMemoryEventRing.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Writes events into a ring buffer in POSIX shared memory.
+ *        There must be only one writer per shared memory object.
+ */
+class SharedMemoryEventWriter {
+ public:
+  /**
+   * @brief Constructor creates the shared memory object. An existing object
+   *        with the same name is replaced.
+   *
+   * @param name Name of the shared memory object (e.g. "/events")
+   * @param capacity Number of events in the ring buffer (rounded up to a
+   *        power of two, at most kSharedMemoryEventRingMaxCapacity), needs
+   *        32 bytes of shared memory per event
+   * @param width Width of the frames
+   * @param height Height of the frames
+   */
+  SharedMemoryEventWriter(const std::string &name, const std::size_t capacity,
+                          const unsigned int width, const unsigned int height)
+      : name_{name} {
+    if (capacity == 0 || capacity > kSharedMemoryEventRingMaxCapacity) {
+      throw std::invalid_argument(
+          "Capacity of the ring buffer must be in [1, 2^32]");
+    }
+    capacity_ = 1;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    size_ = sharedMemoryEventRingSize(capacity_);
+
+    shm_unlink(name_.c_str());
+    fd_ = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd_ < 0) {
+      throw std::runtime_error("shm_open failed for " + name_ + ": " +
+                               std::strerror(errno));
+    }
+    if (ftruncate(fd_, size_) != 0) {
+      const std::string error = std::strerror(errno);
+      close(fd_);
+      shm_unlink(name_.c_str());
+      throw std::runtime_error("ftruncate failed for " + name_ + ": " + error);
+    }
+    // Reserve the memory now, otherwise writing to the sparse object fails
+    // with SIGBUS once /dev/shm is full (e.g. 64 MiB in Docker)
+    const int result = posix_fallocate(fd_, 0, size_);
+    if (result != 0) {
+      close(fd_);
+      shm_unlink(name_.c_str());
+      throw std::runtime_error("posix_fallocate failed for " + name_ + ": " +
+                               std::strerror(result));
+    }
+
+    void *memory =
+        mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (memory == MAP_FAILED) {
+      const std::string error = std::strerror(errno);
+      close(fd_);
+      shm_unlink(name_.c_str());
+      throw std::runtime_error("mmap failed for " + name_ + ": " + error);
+    }
+
+    // The memory is zero initialized by ftruncate, i.e. all slots are empty
+    header_ = new (memory) SharedMemoryEventRingHeader;
+    header_->version = kSharedMemoryEventRingVersion;
+    header_->capacity = capacity_;
+    header_->width = width;
+    header_->height = height;
+    header_->generation =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    header_->alive.store(1, std::memory_order_relaxed);
+    header_->head.store(0, std::memory_order_relaxed);
+    slots_ = sharedMemoryEventSlots(header_);
+    header_->magic.store(kSharedMemoryEventRingMagic,
+                         std::memory_order_release);
+  }
+
+  SharedMemoryEventWriter(const SharedMemoryEventWriter &) = delete;
+  SharedMemoryEventWriter &operator=(const SharedMemoryEventWriter &) = delete;
+
+  /**
+   * @brief Destructor unmaps and removes the shared memory object.
+   *        Readers which already mapped it keep their mapping.
+   */
+  ~SharedMemoryEventWriter() {
+    header_->alive.store(0, std::memory_order_release);
+    munmap(header_, size_);
+    close(fd_);
+    shm_unlink(name_.c_str());
+  }
+
+  /**
+   * @brief Writes the events into the ring buffer and publishes them to the
+   *        readers at once.
+   *
+   * @param events Simulated events (need x, y, timestamp and polarity), the
+   *        time stamps are relative to base_timestamp_ns
+   * @param base_timestamp_ns Absolute time stamp the event time stamps are
+   *        relative to [ns]
+   */
+  template <typename EventContainer>
+  void write(const EventContainer &events,
+             const std::uint64_t base_timestamp_ns) {
+    const std::uint64_t mask = capacity_ - 1;
+
+    for (const auto &event : events) {
+      auto &slot = slots_[head_ & mask];
+
+      // Seqlock: invalidate the slot, write the event, validate the slot
+      slot.sequence.store(0, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.event.timestamp_ns = base_timestamp_ns + event.timestamp;
+      slot.event.x = event.x;
+      slot.event.y = event.y;
+      slot.event.polarity = event.polarity ? 1 : 0;
+      slot.sequence.store(head_ + 1, std::memory_order_release);
+
+      ++head_;
+    }
+
+    header_->head.store(head_, std::memory_order_release);
+  }
+
+  /**
+   * @brief Returns the number of events written so far.
+   */
+  std::uint64_t getNumEvents() const { return head_; }
+
+ private:
+  /// Name of the shared memory object
+  std::string name_;
+
+  /// File descriptor of the shared memory object
+  int fd_;
+
+  /// Size of the shared memory object [bytes]
+  std::size_t size_;
+
+  /// Number of slots
+  std::uint64_t capacity_;
+
+  /// Header of the ring buffer
+  SharedMemoryEventRingHeader *header_;
+
+  /// Slots of the ring buffer
+  SharedMemoryEventSlot *slots_;
+
+  /// Sequence number of the next event
+  std::uint64_t head_ = 0;
+};
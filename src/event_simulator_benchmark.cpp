@@ -0,0 +1,355 @@
+/* Microbenchmark suite for the event simulators based on procedurally
+ * generated scenes. No video file or camera is needed, so the suite runs
+ * offline. Reported are the events per second and the pixels per second
+ * for each CPU event simulator, the ingestion of ROS image messages and the
+ * construction of the event array messages.
+ *
+ * @note: Use "--benchmark_filter=<regex>" to run only a subset
+ */
+
+#include <benchmark/benchmark.h>
+#include <cv_bridge/cv_bridge.h>
+#include <event_simulator/BasicDifferenceEventSimulator.h>
+#include <event_simulator/BasicEventSimulator.h>
+#include <event_simulator/DISOpticalFlowCalculator.h>
+#include <event_simulator/DenseInterpolatedEventSimulator.h>
+#include <event_simulator/DifferenceInterpolatedEventSimulator.h>
+#include <event_simulator/FarnebackFlowCalculator.h>
+#include <event_simulator/LKOpticalFlowCalculator.h>
+#include <event_simulator/OpticalFlow.h>
+#include <event_simulator/SparseInterpolatedEventSimulator.h>
+#include <event_simulator_ros/EventArrayConversion.h>
+#include <event_simulator_ros/ImageConversion.h>
+#include <prophesee_event_msgs/EventArray.h>
+#include <sensor_msgs/Image.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <opencv2/imgproc.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Number of pre-generated frame pairs per scene, the benchmarks cycle
+/// through them (i.e. kNumFrames + 1 frames are generated)
+constexpr int kNumFrames = 16;
+
+/// Time between two frames [ns] (30 fps)
+constexpr unsigned int kFrameTimeNs = 33333333;
+
+// Thresholds, same as the defaults in config/config.yaml
+constexpr int kNumInterFrames = 20;
+constexpr int kCPosBasicDifference = 20;
+constexpr int kCNegBasicDifference = 20;
+constexpr int kCPosDense = 3;
+constexpr int kCNegDense = 3;
+constexpr int kCPosSparse = 6;
+constexpr int kCNegSparse = 6;
+constexpr int kCPosDifference = 19;
+constexpr int kCNegDifference = 19;
+constexpr int kCOffset = 10;
+
+/**
+ * @brief Procedural scene types.
+ */
+enum class Scene { TRANSLATION, ROTATION, FLICKER };
+
+const std::vector<std::pair<Scene, std::string>> kScenes = {
+    {Scene::TRANSLATION, "translation"},
+    {Scene::ROTATION, "rotation"},
+    {Scene::FLICKER, "flicker"}};
+
+const std::vector<cv::Size> kResolutions = {
+    cv::Size(346, 260), cv::Size(640, 480), cv::Size(1280, 720)};
+
+const std::vector<std::string> kSimulatorTypes = {
+    "basic",        "basic_difference",    "difference_cpu",
+    "sparse_cpu",   "dense_farneback_cpu", "dense_dis_lq",
+    "dense_dis_hq"};
+
+/**
+ * @brief Creates a smooth random texture which is deterministic for a
+ *        given size.
+ *
+ * @param size Size of the texture
+ * @return Grey scale texture
+ */
+cv::Mat createTexture(const cv::Size &size) {
+  cv::Mat noise(size.height / 8 + 1, size.width / 8 + 1, CV_8UC1);
+  cv::RNG rng(42);
+  rng.fill(noise, cv::RNG::UNIFORM, 0, 256);
+
+  cv::Mat texture;
+  cv::resize(noise, texture, size, 0, 0, cv::INTER_CUBIC);
+  return texture;
+}
+
+/**
+ * @brief Creates a radial pattern with sharp edges (used for the rotation
+ *        scene).
+ *
+ * @param size Size of the pattern
+ * @return Grey scale pattern
+ */
+cv::Mat createRadialPattern(const cv::Size &size) {
+  cv::Mat pattern(size, CV_8UC1);
+  const cv::Point2f center(size.width / 2.0f, size.height / 2.0f);
+  for (int y = 0; y < size.height; ++y) {
+    auto *row = pattern.ptr<uchar>(y);
+    for (int x = 0; x < size.width; ++x) {
+      const float angle = std::atan2(y - center.y, x - center.x);
+      const float radius = std::hypot(x - center.x, y - center.y);
+      const bool sector = std::sin(12.0f * angle) > 0.0f;
+      const bool ring = std::sin(0.1f * radius) > 0.0f;
+      row[x] = sector != ring ? 220 : 30;
+    }
+  }
+  return pattern;
+}
+
+/**
+ * @brief Generates the frames of a procedural scene.
+ *
+ * @param scene Scene type
+ * @param size Resolution of the frames
+ * @return kNumFrames + 1 consecutive grey scale frames
+ */
+std::vector<cv::Mat> createScene(const Scene scene, const cv::Size &size) {
+  std::vector<cv::Mat> frames;
+  frames.reserve(kNumFrames + 1);
+
+  switch (scene) {
+    case Scene::TRANSLATION: {
+      // Texture moving diagonally with 2 px per frame
+      const auto texture = createTexture(size);
+      for (int i = 0; i <= kNumFrames; ++i) {
+        const cv::Mat transform =
+            (cv::Mat_<double>(2, 3) << 1, 0, 2.0 * i, 0, 1, 1.0 * i);
+        cv::Mat frame;
+        cv::warpAffine(texture, frame, transform, size, cv::INTER_LINEAR,
+                       cv::BORDER_REFLECT);
+        frames.emplace_back(frame);
+      }
+      break;
+    }
+    case Scene::ROTATION: {
+      // Pattern rotating around the image center with 2 deg per frame
+      const auto pattern = createRadialPattern(size);
+      const cv::Point2f center(size.width / 2.0f, size.height / 2.0f);
+      for (int i = 0; i <= kNumFrames; ++i) {
+        const auto transform = cv::getRotationMatrix2D(center, 2.0 * i, 1.0);
+        cv::Mat frame;
+        cv::warpAffine(pattern, frame, transform, size, cv::INTER_LINEAR,
+                       cv::BORDER_REFLECT);
+        frames.emplace_back(frame);
+      }
+      break;
+    }
+    case Scene::FLICKER: {
+      // Static texture with a sinusoidally changing brightness
+      const auto texture = createTexture(size);
+      for (int i = 0; i <= kNumFrames; ++i) {
+        const double gain =
+            0.75 + 0.25 * std::sin(2.0 * CV_PI * i / kNumFrames);
+        cv::Mat frame;
+        texture.convertTo(frame, CV_8UC1, gain);
+        frames.emplace_back(frame);
+      }
+      break;
+    }
+  }
+
+  return frames;
+}
+
+/**
+ * @brief Creates a CPU event simulator (same types as the ROS node).
+ *
+ * @param type Event simulator type
+ * @return Event simulator
+ */
+std::shared_ptr<EventSimulator> createEventSimulator(const std::string &type) {
+  if (type == "basic") {
+    return std::make_shared<BasicEventSimulator>();
+  } else if (type == "basic_difference") {
+    return std::make_shared<BasicDifferenceEventSimulator>(
+        kCPosBasicDifference, kCNegBasicDifference);
+  } else if (type == "difference_cpu") {
+    return std::make_shared<DifferenceInterpolatedEventSimulator>(
+        std::make_shared<LKOpticalFlowCalculator>(), kNumInterFrames,
+        kCPosDifference, kCNegDifference, kCPosDifference + kCOffset,
+        kCNegDifference + kCOffset);
+  } else if (type == "sparse_cpu") {
+    return std::make_shared<SparseInterpolatedEventSimulator>(
+        std::make_shared<LKOpticalFlowCalculator>(), kNumInterFrames,
+        kCPosSparse, kCNegSparse);
+  } else if (type == "dense_farneback_cpu") {
+    return std::make_shared<DenseInterpolatedEventSimulator>(
+        std::make_shared<FarnebackFlowCalculator>(), kNumInterFrames,
+        kCPosDense, kCNegDense);
+  } else if (type == "dense_dis_lq") {
+    return std::make_shared<DenseInterpolatedEventSimulator>(
+        std::make_shared<DISOpticalFlowCalculator>(DISOpticalFlowQuality::LOW),
+        kNumInterFrames, kCPosDense, kCNegDense);
+  } else if (type == "dense_dis_hq") {
+    return std::make_shared<DenseInterpolatedEventSimulator>(
+        std::make_shared<DISOpticalFlowCalculator>(
+            DISOpticalFlowQuality::HIGH),
+        kNumInterFrames, kCPosDense, kCNegDense);
+  }
+
+  throw std::invalid_argument("Simulator type does not exist");
+}
+
+/**
+ * @brief Sets the events/s and pixels/s counters.
+ *
+ * @param state Benchmark state
+ * @param num_events Total number of processed events
+ * @param num_pixels Total number of processed pixels
+ */
+void setCounters(benchmark::State &state, const double num_events,
+                 const double num_pixels) {
+  state.counters["events"] =
+      benchmark::Counter(num_events, benchmark::Counter::kAvgIterations);
+  state.counters["events/s"] =
+      benchmark::Counter(num_events, benchmark::Counter::kIsRate);
+  state.counters["pixels/s"] =
+      benchmark::Counter(num_pixels, benchmark::Counter::kIsRate);
+}
+
+/**
+ * @brief Benchmarks the event simulation of one frame pair.
+ */
+void benchmarkSimulator(benchmark::State &state, const std::string &type,
+                        const Scene scene, const cv::Size &size) {
+  const auto frames = createScene(scene, size);
+  auto event_simulator = createEventSimulator(type);
+  event_simulator->setup(size);
+
+  double num_events = 0.0;
+  double num_pixels = 0.0;
+  int i = 0;
+
+  for (auto _ : state) {
+    const int frame_nr = i % kNumFrames;
+    const unsigned int prev_timestamp_ns = frame_nr * kFrameTimeNs;
+    int number_of_frames;
+
+    auto events = event_simulator->getEvents(
+        frames[frame_nr], frames[frame_nr + 1], prev_timestamp_ns,
+        prev_timestamp_ns + kFrameTimeNs, number_of_frames);
+    benchmark::DoNotOptimize(events.data());
+
+    num_events += events.size();
+    num_pixels += size.area();
+    ++i;
+  }
+
+  setCounters(state, num_events, num_pixels);
+}
+
+/**
+ * @brief Benchmarks the ingestion of a frame as done in the ROS node, i.e.
+ *        the conversion of the image message and the grey scale conversion.
+ */
+void benchmarkIngestion(benchmark::State &state, const cv::Size &size) {
+  const auto frames = createScene(Scene::TRANSLATION, size);
+  std::vector<sensor_msgs::ImageConstPtr> msgs;
+  for (const auto &frame : frames) {
+    cv::Mat bgr_frame;
+    cv::cvtColor(frame, bgr_frame, cv::COLOR_GRAY2BGR);
+    msgs.emplace_back(
+        cv_bridge::CvImage(std_msgs::Header(), "bgr8", bgr_frame).toImageMsg());
+  }
+
+  cv_bridge::CvImagePtr cv_ptr;
+  cv::Mat grey_frame;
+  std::uint64_t timestamp_ns;
+  double num_pixels = 0.0;
+  int i = 0;
+
+  for (auto _ : state) {
+    toGreyFrame(msgs[i % msgs.size()], cv_ptr, grey_frame, timestamp_ns);
+    benchmark::DoNotOptimize(grey_frame.data);
+
+    num_pixels += size.area();
+    ++i;
+  }
+
+  setCounters(state, 0.0, num_pixels);
+}
+
+/**
+ * @brief Benchmarks the construction of the event array message in
+ *        isolation. The events are simulated beforehand.
+ */
+void benchmarkEventArray(benchmark::State &state, const Scene scene,
+                         const cv::Size &size) {
+  const auto frames = createScene(scene, size);
+  auto event_simulator = createEventSimulator("difference_cpu");
+  event_simulator->setup(size);
+
+  int number_of_frames;
+  const auto events = event_simulator->getEvents(frames[0], frames[1], 0,
+                                                 kFrameTimeNs,
+                                                 number_of_frames);
+
+  std_msgs::Header header;
+  prophesee_event_msgs::EventArray event_array_msg;
+  double num_events = 0.0;
+  double num_pixels = 0.0;
+
+  for (auto _ : state) {
+    toEventArrayMsg(events, 0, header, size.width, size.height,
+                    event_array_msg);
+    benchmark::DoNotOptimize(event_array_msg.events.data());
+
+    num_events += events.size();
+    num_pixels += size.area();
+  }
+
+  setCounters(state, num_events, num_pixels);
+}
+
+std::string toString(const cv::Size &size) {
+  return std::to_string(size.width) + "x" + std::to_string(size.height);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  for (const auto &size : kResolutions) {
+    for (const auto &type : kSimulatorTypes) {
+      for (const auto &scene : kScenes) {
+        benchmark::RegisterBenchmark(
+            ("simulator/" + type + "/" + scene.second + "/" + toString(size))
+                .c_str(),
+            benchmarkSimulator, type, scene.first, size)
+            ->Unit(benchmark::kMillisecond);
+      }
+    }
+
+    benchmark::RegisterBenchmark(("ingestion/" + toString(size)).c_str(),
+                                 benchmarkIngestion, size)
+        ->Unit(benchmark::kMicrosecond);
+
+    for (const auto &scene : kScenes) {
+      benchmark::RegisterBenchmark(
+          ("event_array/" + scene.second + "/" + toString(size)).c_str(),
+          benchmarkEventArray, scene.first, size)
+            ->Unit(benchmark::kMicrosecond);
+    }
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
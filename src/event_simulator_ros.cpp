@@ -10,6 +10,9 @@
 #include <event_simulator/LKOpticalFlowCalculator.h>
 #include <event_simulator/OpticalFlow.h>
 #include <event_simulator/SparseInterpolatedEventSimulator.h>
+#include <event_simulator_ros/EventArrayConversion.h>
+#include <event_simulator_ros/ImageConversion.h>
+#include <event_simulator_ros/SharedMemoryEventWriter.h>
 #include <image_transport/image_transport.h>
 #include <prophesee_event_msgs/EventArray.h>
 #include <ros/ros.h>
@@ -17,6 +20,8 @@
 #include <sensor_msgs/Image.h>
 #include <std_msgs/Header.h>
 
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
 #ifdef USE_CUDA
 #include <event_simulator/CudaFarnebackFlowCalculator.h>
@@ -34,7 +39,10 @@ class EventSimulatorNode {
    * @param node_handle The ROS node handle
    * @param event_simulator_type Type of event simulator used
    * @param publish_events Flag indicating if events will be published or not
-   * @param publish_event_frames Flag indicating if accumulated event frames will be published or noFlag indicating if accumulated event frames will be published or not   * @param c_pos [TODO:description]
+   * @param publish_event_frames Flag indicating if accumulated event frames will be published or not
+   * @param shared_memory_name Name of the shared memory ring buffer the events are written to (empty to disable)
+   * @param shared_memory_capacity Number of events in the shared memory ring buffer
+   * @param c_pos Positive threshold
    * @param c_neg Negative threshold
    * @param c_offset Offset (used to calculate the intermediate thresholds)
    * @param num_inter_frames Number of interpolated frames
@@ -42,12 +50,17 @@ class EventSimulatorNode {
    */
   EventSimulatorNode(ros::NodeHandle &node_handle,
                      const std::string &event_simulator_type, const bool publish_events,
-                     const bool publish_event_frames, const int c_pos = 20, const int c_neg = 20,
+                     const bool publish_event_frames,
+                     const std::string &shared_memory_name,
+                     const std::size_t shared_memory_capacity, const int c_pos = 20,
+                     const int c_neg = 20,
                      const int c_offset = 10, const int num_inter_frames = 10,
                      const int div_factor = 10)
       : image_transport_{node_handle},
         publish_events_{publish_events},
         publish_event_frames_{publish_event_frames},
+        shared_memory_name_{shared_memory_name},
+        shared_memory_capacity_{shared_memory_capacity},
         initialized_{false} {
     std::shared_ptr<SparseOpticalFlowCalculator> sparse_optical_flow = nullptr;
     std::shared_ptr<DenseOpticalFlowCalculator> dense_optical_flow = nullptr;
@@ -131,14 +144,11 @@ class EventSimulatorNode {
    * @param msg ROS message containing the frame
    */
   void imageCallback(const sensor_msgs::Image::ConstPtr &msg) {
-    if (publish_events_ || publish_event_frames_) {
-      try {
-        cv_ptr_ = cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8);
-
-        grey_frame_ = cv::Mat::zeros(msg->width, msg->height, CV_8UC3);
-        cv::cvtColor(cv_ptr_->image, grey_frame_, cv::COLOR_BGR2GRAY);
+    const bool write_shared_memory = !shared_memory_name_.empty();
 
-        timestamp_ns_ = msg->header.stamp.nsec + msg->header.stamp.sec * 1e-9;
+    if (publish_events_ || publish_event_frames_ || write_shared_memory) {
+      try {
+        toGreyFrame(msg, cv_ptr_, grey_frame_, timestamp_ns_);
       } catch (cv_bridge::Exception &e) {
         ROS_ERROR("cv_bridge exception: %s", e.what());
         return;
@@ -149,8 +159,25 @@ class EventSimulatorNode {
         cam_info_msg_.width = msg->width;
         cam_info_msg_.height = msg->height;
         cam_info_msg_.header.frame_id = "PropheseeCamera_optical_frame";
+        if (write_shared_memory) {
+          shared_memory_writer_ = std::make_unique<SharedMemoryEventWriter>(
+              shared_memory_name_, shared_memory_capacity_, msg->width,
+              msg->height);
+        }
         initialized_ = true;
       } else {
+        // The events are simulated relative to the previous frame, i.e. the
+        // time stamps have to increase by less than 2^32 ns (~4.29 s)
+        if (timestamp_ns_ <= prev_timestamp_ns_ ||
+            timestamp_ns_ - prev_timestamp_ns_ > UINT32_MAX) {
+          ROS_WARN_STREAM("Time stamp jumped from "
+                          << prev_timestamp_ns_ << " ns to " << timestamp_ns_
+                          << " ns, skipping the frame pair");
+          prev_frame_ = grey_frame_;
+          prev_timestamp_ns_ = timestamp_ns_;
+          return;
+        }
+
         int number_of_frames;
 
         if (publish_event_frames_) {
@@ -165,30 +192,27 @@ class EventSimulatorNode {
           }
         }
 
-        if (publish_events_) {
+        if (publish_events_ || write_shared_memory) {
+          // The simulator works with 32 bit time stamps, i.e. the events are
+          // simulated relative to the previous frame and the 64 bit time
+          // stamp of the previous frame is added when they are written out
           auto events = event_simulator_->getEvents(
-              prev_frame_, grey_frame_, prev_timestamp_ns_, timestamp_ns_,
+              prev_frame_, grey_frame_, 0,
+              static_cast<unsigned int>(timestamp_ns_ - prev_timestamp_ns_),
               number_of_frames);
 
-          event_array_msg_.header = msg->header;
-          event_array_msg_.width = msg->width;
-          event_array_msg_.height = msg->height;
-          event_array_msg_.events.clear();
-          event_array_msg_.events.reserve(events.size());
-
-          prophesee_event_msgs::Event event_msg;
-          for (const auto &event : events) {
-            event_msg.x = event.x;
-            event_msg.y = event.y;
-            event_msg.ts.sec = 0.0;
-            event_msg.ts.nsec = event.timestamp;
-            event_msg.polarity = event.polarity;
-            event_array_msg_.events.push_back(event_msg);
+          if (write_shared_memory) {
+            shared_memory_writer_->write(events, prev_timestamp_ns_);
           }
 
-          cam_info_msg_.header.stamp = msg->header.stamp;
-          pub_info_.publish(cam_info_msg_);
-          events_publisher_.publish(event_array_msg_);
+          if (publish_events_) {
+            toEventArrayMsg(events, prev_timestamp_ns_, msg->header,
+                            msg->width, msg->height, event_array_msg_);
+
+            cam_info_msg_.header.stamp = msg->header.stamp;
+            pub_info_.publish(cam_info_msg_);
+            events_publisher_.publish(event_array_msg_);
+          }
         }
       }
 
@@ -231,6 +255,15 @@ class EventSimulatorNode {
   /// Flag indicating if accumulated event frames should be published or not
   bool publish_event_frames_;
 
+  /// Name of the shared memory ring buffer (empty if disabled)
+  std::string shared_memory_name_;
+
+  /// Number of events in the shared memory ring buffer
+  std::size_t shared_memory_capacity_;
+
+  /// Writer of the shared memory ring buffer (created with the first frame)
+  std::unique_ptr<SharedMemoryEventWriter> shared_memory_writer_;
+
   /// Pointer to the event simulator
   std::unique_ptr<EventSimulator> event_simulator_;
 
@@ -238,10 +271,10 @@ class EventSimulatorNode {
   cv::Mat prev_frame_;
 
   /// Time stamp [ns]
-  unsigned int timestamp_ns_;
+  std::uint64_t timestamp_ns_;
 
   /// Previous time stamp [ns]
-  unsigned int prev_timestamp_ns_;
+  std::uint64_t prev_timestamp_ns_;
 
   /// Flag indicating if the ROS node is initialized or not
   bool initialized_;
@@ -266,8 +299,23 @@ int main(int argc, char **argv) {
     ROS_WARN_STREAM("Publish event frames: " << publish_event_frames);
   }
 
-  EventSimulatorNode event_simulator_node(node_handle, event_simulator_type,
-                                          publish_events, publish_event_frames);
+  std::string shared_memory_name;
+  if (node_handle.param("shared_memory_name", shared_memory_name,
+                        std::string(""))) {
+    ROS_WARN_STREAM("Shared memory name: " << shared_memory_name);
+  }
+  int shared_memory_capacity;
+  if (node_handle.param("shared_memory_capacity", shared_memory_capacity,
+                        1 << 22)) {
+    ROS_WARN_STREAM("Shared memory capacity: " << shared_memory_capacity);
+  }
+  if (shared_memory_capacity <= 0) {
+    throw std::invalid_argument("Shared memory capacity must be > 0");
+  }
+
+  EventSimulatorNode event_simulator_node(
+      node_handle, event_simulator_type, publish_events, publish_event_frames,
+      shared_memory_name, shared_memory_capacity);
   ros::Subscriber image_subscriber = node_handle.subscribe(
       "/usb_cam/image_raw", 10, &EventSimulatorNode::imageCallback,
       &event_simulator_node);
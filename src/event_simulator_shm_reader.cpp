@@ -0,0 +1,84 @@
+/* Example consumer which reads the events from the shared memory ring buffer
+ * written by event_simulator_ros or event_simulator_video. Prints the event
+ * rate and the number of lost events once per second. Waits until the ring
+ * buffer is created and reconnects if the producer is restarted.
+ *
+ * @note: Does not depend on ROS, only on SharedMemoryEventReader.h
+ */
+
+#include <event_simulator_ros/SharedMemoryEventReader.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Waits until the ring buffer is available and attaches to it.
+ *
+ * @param name Name of the shared memory object
+ * @return Reader attached to the ring buffer
+ */
+std::unique_ptr<SharedMemoryEventReader> connect(const std::string &name) {
+  std::cout << "Waiting for " << name << std::endl;
+  while (true) {
+    try {
+      auto reader = std::make_unique<SharedMemoryEventReader>(name);
+      if (reader->isProducerAlive()) {
+        std::cout << "Reading events from " << name << " ("
+                  << reader->getWidth() << "x" << reader->getHeight() << ")"
+                  << std::endl;
+        return reader;
+      }
+    } catch (const std::runtime_error &) {
+      // Not created or not initialized yet
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}
+
+int main(int argc, const char *argv[]) {
+  const std::string name = argc > 1 ? argv[1] : "/event_simulator_events";
+
+  auto reader = connect(name);
+
+  std::vector<SharedMemoryEvent> events;
+  events.reserve(1 << 16);
+
+  std::size_t num_events = 0;
+  std::size_t num_positive_events = 0;
+  auto last_report = std::chrono::steady_clock::now();
+
+  while (true) {
+    if (reader->read(events, 1 << 16) == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    for (const auto &event : events) {
+      num_positive_events += event.polarity;
+    }
+    num_events += events.size();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_report >= std::chrono::seconds(1)) {
+      std::cout << "events/s: " << num_events
+                << " positive: " << num_positive_events
+                << " sequence: " << reader->getSequence()
+                << " lost: " << reader->getLostEvents() << std::endl;
+      num_events = 0;
+      num_positive_events = 0;
+      last_report = now;
+
+      if (events.empty() && !reader->isProducerAlive()) {
+        std::cout << "Producer stopped" << std::endl;
+        reader.reset();
+        reader = connect(name);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -1,6 +1,9 @@
 /* Main application which uses the event simulator library to simulate events
  * given frames from a video. The accumulated event frames can be recorded 
  * and event statistics can be calculate.
+ * Alternatively (exclusive mode, without statistics, recording and display),
+ * the events can be written into a shared memory ring buffer (see
+ * event_simulator_shm_reader for an example consumer).
  */
 
 #include <event_simulator/DISOpticalFlowCalculator.h>
@@ -11,16 +14,94 @@
 #include <event_simulator/OpticalFlow.h>
 #include <event_simulator/Player.h>
 #include <event_simulator/SparseInterpolatedEventSimulator.h>
+#include <event_simulator_ros/SharedMemoryEventWriter.h>
 
 #include <boost/program_options.hpp>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
 #include <string>
+#include <thread>
 #ifdef USE_CUDA
 #include <event_simulator/CudaFarnebackFlowCalculator.h>
 #include <event_simulator/CudaLKOpticalFlowCalculator.h>
 #endif
 
+/**
+ * @brief Simulates the events of a video and writes them into a shared
+ *        memory ring buffer. The frames are processed with the frame rate
+ *        of the video.
+ *
+ * @param event_simulator Event simulator
+ * @param video_path Path and filename of the video
+ * @param height Height the frames are resized to (0 to keep the size)
+ * @param width Width the frames are resized to (0 to keep the size)
+ * @param shared_memory_name Name of the shared memory ring buffer
+ * @param shared_memory_capacity Number of events in the ring buffer
+ */
+void simulateToSharedMemory(std::shared_ptr<EventSimulator> event_simulator,
+                            const std::string &video_path, const int height,
+                            const int width,
+                            const std::string &shared_memory_name,
+                            const std::size_t shared_memory_capacity) {
+  cv::VideoCapture cap(video_path);
+  if (!cap.isOpened()) {
+    throw std::runtime_error("Could not open video " + video_path);
+  }
+
+  const double fps = cap.get(cv::CAP_PROP_FPS) > 0 ? cap.get(cv::CAP_PROP_FPS)
+                                                    : 30.0;
+  const auto frame_time = std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(std::chrono::duration<double>(
+      1.0 / fps));
+
+  cv::Mat frame;
+  cv::Mat grey_frame;
+  cv::Mat prev_frame;
+  std::unique_ptr<SharedMemoryEventWriter> writer;
+  std::uint64_t prev_timestamp_ns = 0;
+  std::uint64_t frame_nr = 0;
+  auto next_frame_time = std::chrono::steady_clock::now();
+
+  while (cap.read(frame)) {
+    if (height > 0 && width > 0) {
+      cv::resize(frame, frame, cv::Size(width, height));
+    }
+    cv::cvtColor(frame, grey_frame, cv::COLOR_BGR2GRAY);
+    const auto timestamp_ns = static_cast<std::uint64_t>(frame_nr * 1e9 / fps);
+
+    if (!writer) {
+      event_simulator->setup(grey_frame.size());
+      writer = std::make_unique<SharedMemoryEventWriter>(
+          shared_memory_name, shared_memory_capacity, grey_frame.cols,
+          grey_frame.rows);
+    } else {
+      // The simulator works with 32 bit time stamps, i.e. the events are
+      // simulated relative to the previous frame
+      int number_of_frames;
+      auto events = event_simulator->getEvents(
+          prev_frame, grey_frame, 0,
+          static_cast<unsigned int>(timestamp_ns - prev_timestamp_ns),
+          number_of_frames);
+      writer->write(events, prev_timestamp_ns);
+    }
+
+    grey_frame.copyTo(prev_frame);
+    prev_timestamp_ns = timestamp_ns;
+    ++frame_nr;
+
+    next_frame_time += frame_time;
+    std::this_thread::sleep_until(next_frame_time);
+  }
+
+  if (writer) {
+    std::cout << "Wrote " << writer->getNumEvents() << " events to "
+              << shared_memory_name << std::endl;
+  }
+}
+
 int main(int argc, const char *argv[]) {
   boost::program_options::options_description od{"Options"};
   od.add_options()("help,h", "Help screen")(
@@ -51,7 +132,15 @@ int main(int argc, const char *argv[]) {
       "c_offset", boost::program_options::value<int>()->default_value(10),
       "C offset")("num_inter_frames",
                   boost::program_options::value<int>()->default_value(10),
-                  "Number of interpolated inter frames");
+                  "Number of interpolated inter frames")(
+      "shared_memory",
+      boost::program_options::value<std::string>()->default_value(""),
+      "Name of the shared memory ring buffer the events are written to (e.g. "
+      "/event_simulator_events). Exclusive mode, can not be combined with "
+      "statistics, record_video and wait_time")(
+      "shared_memory_capacity",
+      boost::program_options::value<int>()->default_value(1 << 22),
+      "Number of events in the shared memory ring buffer");
 
   boost::program_options::variables_map vm;
   boost::program_options::store(
@@ -133,6 +222,24 @@ int main(int argc, const char *argv[]) {
     throw std::invalid_argument("Simulator type does not exist");
   }
 
+  const auto shared_memory_name = vm["shared_memory"].as<std::string>();
+  if (!shared_memory_name.empty()) {
+    if (vm["statistics"].as<bool>() || vm["record_video"].as<bool>() ||
+        !vm["wait_time"].defaulted()) {
+      throw std::invalid_argument(
+          "shared_memory can not be combined with statistics, record_video "
+          "and wait_time");
+    }
+    const auto shared_memory_capacity = vm["shared_memory_capacity"].as<int>();
+    if (shared_memory_capacity <= 0) {
+      throw std::invalid_argument("Shared memory capacity must be > 0");
+    }
+
+    simulateToSharedMemory(event_simulator, video_path, height, width,
+                           shared_memory_name, shared_memory_capacity);
+    return 0;
+  }
+
   auto event_statistics = vm["statistics"].as<bool>();
   auto record_video = vm["record_video"].as<bool>();
   OpenCVPlayer cv_player = OpenCVPlayer(event_simulator, wait_time_ms);